@@ -0,0 +1,186 @@
+#include "EventStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::atomic_ref<uint64_t>::is_always_lock_free,
+              "slot sequence words must be readable from a read-only mapping");
+
+/**
+ * @brief Открытие хранилища на запись (создается при отсутствии)
+ * @param path Путь к файлу, например /dev/shm/events
+ * @param n_chan Число каналов
+ * @param n_bins Число бинов в кадре
+ * @param n_slots Число слотов кольцевого буфера
+ */
+EventStore::EventStore(const std::string &path, int n_chan, int n_bins, int n_slots) {
+    fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to open the event store " << path << "!" << std::endl;
+        return;
+    }
+    flock(fd, LOCK_EX);
+    struct stat st{};
+    fstat(fd, &st);
+    mapSize = sizeof(Header) + size_t(n_slots) *
+                               (sizeof(SlotHeader) + size_t(n_chan) * size_t(n_bins) * sizeof(int32_t));
+    bool fresh{st.st_size == 0};
+    if (fresh && ftruncate(fd, off_t(mapSize)) != 0) {
+        std::cerr << "Failed to allocate the event store " << path << "!" << std::endl;
+        flock(fd, LOCK_UN);
+        return;
+    }
+    if (!fresh && size_t(st.st_size) != mapSize) {
+        std::cerr << "Event store " << path << " has another layout!" << std::endl;
+        flock(fd, LOCK_UN);
+        return;
+    }
+    base = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        base = nullptr;
+        std::cerr << "Failed to map the event store " << path << "!" << std::endl;
+        flock(fd, LOCK_UN);
+        return;
+    }
+    auto *h{static_cast<Header *>(base)};
+    if (fresh) {
+        h->n_chan = uint32_t(n_chan);
+        h->n_bins = uint32_t(n_bins);
+        h->n_slots = uint32_t(n_slots);
+        h->version = VERSION;
+        h->write_seq = 0;
+        std::atomic_ref<uint32_t>(h->magic).store(MAGIC, std::memory_order_release);
+    }
+    if (h->magic != MAGIC || h->version != VERSION || h->n_chan != uint32_t(n_chan) ||
+        h->n_bins != uint32_t(n_bins) || h->n_slots != uint32_t(n_slots)) {
+        std::cerr << "Event store " << path << " has another layout!" << std::endl;
+    } else {
+        header = h;
+    }
+    flock(fd, LOCK_UN);
+}
+
+/**
+ * @brief Открытие существующего хранилища потребителем
+ * @param path Путь к файлу хранилища
+ */
+EventStore::EventStore(const std::string &path) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open the event store " << path << "!" << std::endl;
+        return;
+    }
+    flock(fd, LOCK_SH);
+    struct stat st{};
+    fstat(fd, &st);
+    flock(fd, LOCK_UN);
+    if (size_t(st.st_size) < sizeof(Header)) {
+        std::cerr << "Event store " << path << " is not initialized!" << std::endl;
+        return;
+    }
+    mapSize = size_t(st.st_size);
+    base = mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        base = nullptr;
+        std::cerr << "Failed to map the event store " << path << "!" << std::endl;
+        return;
+    }
+    auto *h{static_cast<Header *>(base)};
+    if (std::atomic_ref<uint32_t>(h->magic).load(std::memory_order_acquire) != MAGIC ||
+        h->version != VERSION ||
+        sizeof(Header) + size_t(h->n_slots) * slotSize(h) != mapSize) {
+        std::cerr << "Event store " << path << " has another layout!" << std::endl;
+        return;
+    }
+    header = h;
+}
+
+EventStore::~EventStore() {
+    if (base != nullptr) {
+        munmap(base, mapSize);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+size_t EventStore::slotSize(const Header *h) {
+    return sizeof(SlotHeader) + size_t(h->n_chan) * size_t(h->n_bins) * sizeof(int32_t);
+}
+
+EventStore::SlotHeader *EventStore::slot(uint64_t seq) const {
+    auto *bytes{static_cast<char *>(base) + sizeof(Header)};
+    return reinterpret_cast<SlotHeader *>(bytes + (seq % header->n_slots) * slotSize(header));
+}
+
+/**
+ * @brief Публикация кадра
+ * @param frame Кадр в порядке [канал][бин]
+ * @param info Описание события
+ * @return Порядковый номер события в хранилище
+ */
+uint64_t EventStore::Publish(const std::vector<std::vector<int>> &frame, const EventInfo &info) {
+    uint64_t seq{std::atomic_ref<uint64_t>(header->write_seq).fetch_add(1, std::memory_order_relaxed)};
+    SlotHeader *s{slot(seq)};
+    std::atomic_ref<uint64_t> slot_seq(s->seq);
+    slot_seq.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s->info = info;
+    s->info.shower[sizeof(s->info.shower) - 1] = '\0';
+    auto *out{reinterpret_cast<int32_t *>(s + 1)};
+    for (size_t j{0}; j < header->n_chan && j < frame.size(); j++) {
+        auto n{std::min(size_t(header->n_bins), frame[j].size())};
+        std::copy_n(frame[j].begin(), n, out + j * header->n_bins);
+    }
+    slot_seq.store(2 * seq + 2, std::memory_order_release);
+    return seq;
+}
+
+/**
+ * @brief Число событий, под которые уже выделены слоты
+ *
+ * Последние из них могут еще записываться, для них Frame вернет nullptr.
+ */
+uint64_t EventStore::Head() const {
+    return std::atomic_ref<uint64_t>(header->write_seq).load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Доступ к кадру события без копирования
+ * @param seq Порядковый номер события
+ * @return Указатель на кадр [n_chan][n_bins] или nullptr, если событие
+ * еще не записано или уже перезаписано
+ */
+const int32_t *EventStore::Frame(uint64_t seq) const {
+    SlotHeader *s{slot(seq)};
+    if (std::atomic_ref<uint64_t>(s->seq).load(std::memory_order_acquire) != 2 * seq + 2) {
+        return nullptr;
+    }
+    return reinterpret_cast<const int32_t *>(s + 1);
+}
+
+/**
+ * @brief Описание события без копирования
+ * @param seq Порядковый номер события
+ * @return Указатель на EventInfo или nullptr, как для Frame
+ */
+const EventStore::EventInfo *EventStore::Info(uint64_t seq) const {
+    const int32_t *frame{Frame(seq)};
+    return frame == nullptr ? nullptr : &(reinterpret_cast<const SlotHeader *>(frame) - 1)->info;
+}
+
+/**
+ * @brief Проверка, что кадр не был перезаписан за время чтения
+ * @param seq Порядковый номер события
+ */
+bool EventStore::Valid(uint64_t seq) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return std::atomic_ref<uint64_t>(slot(seq)->seq).load(std::memory_order_relaxed) == 2 * seq + 2;
+}
@@ -0,0 +1,91 @@
+#ifndef EVENT_STORE_H
+#define EVENT_STORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Кольцевой буфер событий в разделяемой памяти
+ *
+ * Файл (обычно в /dev/shm) отображается в память несколькими процессами.
+ * Моделирование публикует кадры, потребители (проверка триггера,
+ * гистограммы, мониторинг) читают их напрямую из отображения без
+ * копирования и разбора текста.
+ *
+ * Каждый слот хранит кадр в порядке канал-бин. Номер слота события n
+ * равен n % n_slots, при записи в поле seq слота лежит 2n+1, после
+ * записи 2n+2. Потребитель проверяет seq до и после чтения кадра.
+ * Рядом с кадром хранится EventInfo: номер события, сид, время и ливень.
+ *
+ * Потребители открывают файл только на чтение.
+ */
+class EventStore {
+public:
+    struct EventInfo {
+        uint64_t eid; /// Номер события (EID для levels.dat в trigger_check)
+        uint64_t seed; /// Сид генератора моделирования
+        int64_t time; /// Время публикации, нс от эпохи Unix
+        char shower[104]; /// Имя файла ливня
+    };
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t n_chan;
+        uint32_t n_bins;
+        uint32_t n_slots;
+        uint32_t reserved;
+        uint64_t write_seq; /// Число выделенных под запись событий
+    };
+
+    struct SlotHeader {
+        uint64_t seq; /// 2n+1 во время записи события n, 2n+2 после
+        uint64_t reserved;
+        EventInfo info;
+    };
+
+    static constexpr uint32_t MAGIC = 0x45565453; /// "STVE"
+    static constexpr uint32_t VERSION = 2;
+
+    int fd{-1};
+    void *base{nullptr};
+    size_t mapSize{0};
+    Header *header{nullptr};
+
+    static size_t slotSize(const Header *);
+
+    SlotHeader *slot(uint64_t) const;
+
+public:
+    EventStore(const std::string &, int, int, int);
+
+    explicit EventStore(const std::string &);
+
+    EventStore(const EventStore &) = delete;
+
+    EventStore &operator=(const EventStore &) = delete;
+
+    ~EventStore();
+
+    bool is_open() const { return header != nullptr; }
+
+    int nChan() const { return int(header->n_chan); }
+
+    int nBins() const { return int(header->n_bins); }
+
+    int nSlots() const { return int(header->n_slots); }
+
+    uint64_t Publish(const std::vector<std::vector<int>> &, const EventInfo &);
+
+    uint64_t Head() const;
+
+    const int32_t *Frame(uint64_t) const;
+
+    const EventInfo *Info(uint64_t) const;
+
+    bool Valid(uint64_t) const;
+};
+
+#endif //EVENT_STORE_H
@@ -0,0 +1,21 @@
+#ifndef TRIGGER_TABLES_H
+#define TRIGGER_TABLES_H
+
+//TL2/TL3 trigger cells: for every PMT the list of cells (<945) it belongs to, 1000 = no cell
+//shared by trigger_check and the in-process trigger emulation of the simulator
+const int triggers[109][33]={{39,48,49,132,133,142,212,222,232,304,305,306,379,388,397,468,469,479,548,559,568,640,647,648,724,734,735,807,816,827,899,900,907},{49,58,59,142,143,152,222,232,242,313,314,315,389,398,407,478,479,488,559,569,579,649,657,658,734,743,744,817,827,837,908,909,917},{40,49,50,133,134,143,213,223,233,305,306,307,380,389,398,469,470,480,549,560,569,641,648,649,725,735,736,808,817,828,900,901,908},{30,39,40,123,124,133,203,213,223,296,297,298,370,379,388,460,461,470,539,549,559,631,639,640,716,725,726,797,807,817,890,891,899},{29,38,39,122,123,132,202,212,222,295,296,297,369,378,387,459,460,469,538,548,558,630,638,639,715,724,725,796,806,816,889,890,898},{38,47,48,131,132,141,211,221,231,303,304,305,378,387,396,467,468,478,547,558,567,639,646,647,723,733,734,806,815,826,898,899,906},{48,57,58,141,142,151,221,231,241,312,313,314,388,397,406,477,478,487,558,568,578,648,656,657,733,742,743,816,826,836,907,908,916},{59,68,69,152,153,162,232,242,252,322,323,324,399,408,416,487,488,498,569,580,589,659,666,667,743,753,754,828,837,847,918,919,926},{50,59,60,143,144,153,223,233,243,314,315,316,390,399,408,479,480,489,560,570,580,650,658,659,735,744,745,818,828,838,909,910,918},{41,50,51,134,135,144,214,224,234,306,307,308,381,390,399,470,471,481,550,561,570,642,649,650,726,736,737,809,818,829,901,902,909},{31,40,41,124,125,134,204,214,224,297,298,299,371,380,389,461,462,471,540,550,560,632,640,641,717,726,727,798,808,818,891,892,900},{21,30,31,114,115,124,194,204,214,288,289,290,362,370,379,451,452,462,530,540,549,623,630,631,707,717,718,788,797,808,882,883,890},{20,29,30,113,114,123,193,203,213,287,288,289,361,369,378,450,451,461,529,539,548,622,629,630,706,716,717,787,796,807,881,882,889},{19,28,29,112,113,122,192,202,212,286,287,288,360,368,377,449,450,460,528,538,547,621,628,629,705,715,716,786,795,806,880,881,888},{28,37,38,121,122,131,201,211,221,294,295,296,368,377,386,458,459,468,537,547,557,629,637,638,714,723,724,795,805,815,888,889,897},{37,46,47,130,131,140,210,220,230,302,303,304,377,386,395,466,467,477,546,557,566,638,645,646,722,732,733,805,814,825,897,898,905},{47,56,57,140,141,150,220,230,240,311,312,313,387,396,405,476,477,486,557,567,577,647,655,656,732,741,742,815,825,835,906,907,915},{57,66,67,150,151,160,230,240,250,320,321,322,397,406,414,485,486,496,567,578,587,657,664,665,741,751,752,826,835,845,916,917,924},{58,67,68,151,152,161,231,241,251,321,322,323,398,407,415,486,487,497,568,579,588,658,665,666,742,752,753,827,836,846,917,918,925},{69,78,79,162,163,171,242,252,260,331,332,333,409,417,424,497,498,507,580,590,597,668,675,676,753,762,763,838,847,855,927,928,935},{60,69,70,153,154,163,233,243,253,323,324,325,400,409,417,488,489,499,570,581,590,660,667,668,744,754,755,829,838,848,919,920,927},{51,60,61,144,145,154,224,234,244,315,316,317,391,400,409,480,481,490,561,571,581,651,659,660,736,745,746,819,829,839,910,911,919},{42,51,52,135,136,145,215,225,235,307,308,309,382,391,400,471,472,482,551,562,571,643,650,651,727,737,738,810,819,830,902,903,910},{32,41,42,125,126,135,205,215,225,298,299,300,372,381,390,462,463,472,541,551,561,633,641,642,718,727,728,799,809,819,892,893,901},{22,31,32,115,116,125,195,205,215,289,290,291,363,371,380,452,453,463,531,541,550,624,631,632,708,718,719,789,798,809,883,884,891},{13,21,22,105,106,115,187,195,205,280,281,282,355,362,370,443,444,453,523,531,540,615,622,623,699,708,709,781,788,798,874,875,882},{12,20,21,104,105,114,186,194,204,279,280,281,354,361,369,442,443,452,522,530,539,614,621,622,698,707,708,780,787,797,873,874,881},{11,19,20,103,104,113,185,193,203,278,279,280,353,360,368,441,442,451,521,529,538,613,620,621,697,706,707,779,786,796,872,873,880},{10,18,19,102,103,112,184,192,202,277,278,279,352,359,367,440,441,450,520,528,537,612,619,620,696,705,706,778,785,795,871,872,879},{18,27,28,111,112,121,191,201,211,285,286,287,359,367,376,448,449,459,527,537,546,620,627,628,704,714,715,785,794,805,879,880,887},{27,36,37,120,121,130,200,210,220,293,294,295,367,376,385,457,458,467,536,546,556,628,636,637,713,722,723,794,804,814,887,888,896},{36,45,46,129,130,139,209,219,229,301,302,303,376,385,394,465,466,476,545,556,565,637,644,645,721,731,732,804,813,824,896,897,904},{46,55,56,139,140,149,219,229,239,310,311,312,386,395,404,475,476,485,556,566,576,646,654,655,731,740,741,814,824,834,905,906,914},{56,65,66,149,150,159,229,239,249,319,320,321,396,405,413,484,485,495,566,577,586,656,663,664,740,750,751,825,834,844,915,916,923},{66,75,76,159,160,168,239,249,257,328,329,330,406,414,421,494,495,504,577,587,594,665,672,673,750,759,760,835,844,852,924,925,932},{67,76,77,160,161,169,240,250,258,329,330,331,407,415,422,495,496,505,578,588,595,666,673,674,751,760,761,836,845,853,925,926,933},{68,77,78,161,162,170,241,251,259,330,331,332,408,416,423,496,497,506,579,589,596,667,674,675,752,761,762,837,846,854,926,927,934},{79,86,87,171,172,178,252,260,339,340,341,418,425,429,506,507,590,598,677,682,683,762,770,848,855,936,937,942,1000,1000,1000,1000,1000},{70,79,80,163,164,172,243,253,332,333,334,410,418,425,498,499,508,581,591,598,669,676,677,754,763,764,839,848,856,928,929,936,1000},{61,70,71,154,155,164,234,244,254,324,325,326,401,410,418,489,490,500,571,582,591,661,668,669,745,755,756,830,839,849,920,921,928},{52,61,62,145,146,155,225,235,245,316,317,392,401,410,481,482,491,562,572,582,652,660,661,737,746,747,820,830,840,911,912,920,1000},{43,52,53,136,137,146,216,226,236,308,309,383,392,401,472,473,552,563,572,651,652,728,738,811,820,831,903,911,1000,1000,1000,1000,1000},{33,42,43,126,127,136,206,216,226,299,300,373,382,391,463,464,473,542,552,562,634,642,643,719,728,729,800,810,820,893,894,902,1000},{23,32,33,116,117,126,196,206,216,290,291,292,364,372,381,453,454,464,532,542,551,625,632,633,709,719,720,790,799,810,884,885,892},{14,22,23,106,107,116,188,196,206,281,282,283,363,371,444,445,454,524,532,541,616,623,624,700,709,710,782,789,799,875,876,883,1000},{7,13,14,98,99,106,183,188,196,273,274,275,355,362,436,437,445,524,531,614,615,693,700,701,781,789,868,874,1000,1000,1000,1000,1000},{6,12,13,97,98,105,182,187,195,272,273,274,354,361,435,436,444,518,523,530,608,613,614,692,699,700,776,780,788,867,868,873,1000},{5,11,12,96,97,104,181,186,194,271,272,273,349,353,360,434,435,443,517,522,529,607,612,613,691,698,699,775,779,787,866,867,872},{4,10,11,95,96,103,185,193,270,271,272,348,352,359,433,434,442,516,521,528,606,611,612,690,697,698,774,778,786,865,866,871,1000},{3,9,10,94,95,102,184,192,269,270,271,347,351,358,433,441,520,527,605,610,611,696,697,777,785,864,865,870,1000,1000,1000,1000,1000},{9,17,18,101,102,111,191,201,276,277,278,351,358,366,439,440,449,519,527,536,611,618,619,695,704,705,777,784,794,870,871,878,1000},{17,26,27,110,111,120,190,200,210,284,285,286,358,366,375,447,448,458,526,536,545,619,626,627,703,713,714,784,793,804,878,879,886},{26,35,36,119,120,129,199,209,219,293,294,366,375,384,456,457,466,535,545,555,627,635,636,712,721,722,793,803,813,886,887,895,1000},{35,44,45,128,129,138,208,218,228,301,302,375,384,393,465,475,544,555,564,636,644,730,731,803,812,823,895,896,1000,1000,1000,1000,1000},{45,54,55,138,139,148,218,228,238,310,311,385,394,403,474,475,484,555,565,575,645,653,654,730,739,740,813,823,833,904,905,913,1000},{55,64,65,148,149,158,228,238,248,318,319,320,395,404,412,483,484,494,565,576,585,655,662,663,739,749,750,824,833,843,914,915,922},{65,74,75,158,159,167,238,248,256,327,328,329,405,413,493,494,503,576,586,593,664,671,672,749,758,759,834,843,851,923,924,931,1000},{75,82,83,167,168,174,248,256,261,335,336,337,414,421,502,503,510,586,594,673,679,758,766,767,844,851,932,933,1000,1000,1000,1000,1000},{76,83,84,168,169,175,249,257,262,336,337,338,415,422,503,504,511,587,595,599,674,679,680,759,767,768,845,852,857,933,934,939,1000},{77,84,85,169,170,176,250,258,263,337,338,339,416,423,427,504,505,512,588,596,600,675,680,681,760,768,769,846,853,858,934,935,940},{78,85,86,170,171,177,251,259,338,339,340,417,424,428,505,506,513,589,597,601,676,681,682,761,769,770,847,854,859,935,936,941,1000},{87,178,260,345,426,513,598,684,687,770,856,943,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{80,87,172,173,253,340,341,419,426,507,508,591,678,683,684,763,849,856,937,938,943,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{71,80,81,164,165,173,244,254,333,334,411,419,426,499,500,582,592,670,677,678,755,764,840,849,929,930,937,1000,1000,1000,1000,1000,1000},{62,71,72,155,156,165,235,245,325,326,402,411,419,490,491,572,583,592,669,670,746,756,831,840,850,921,929,1000,1000,1000,1000,1000,1000},{53,62,146,156,226,236,317,402,411,482,563,573,583,661,738,747,821,831,841,912,921,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{53,137,217,309,402,473,553,573,652,729,821,912,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{34,43,127,137,207,217,300,383,392,464,543,553,563,643,720,729,801,811,821,894,903,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{24,33,34,117,118,127,197,207,217,291,292,373,382,454,455,533,543,552,633,634,710,720,791,800,811,885,893,1000,1000,1000,1000,1000,1000},{15,23,24,107,108,117,189,197,207,282,283,364,372,445,446,455,533,542,624,625,701,710,711,790,800,876,884,1000,1000,1000,1000,1000,1000},{14,15,99,107,189,197,274,275,363,437,438,446,532,615,616,694,701,702,782,790,875,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{7,99,189,268,355,432,438,524,608,694,782,868,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{6,7,93,98,183,188,267,268,354,431,432,437,523,607,608,689,693,694,776,781,867,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{2,5,6,92,93,97,182,187,266,267,268,349,353,430,431,436,518,522,606,607,688,692,693,775,780,862,866,1000,1000,1000,1000,1000,1000},{1,4,5,91,92,96,181,186,265,266,267,348,352,430,435,517,521,603,605,606,691,692,774,779,861,862,865,1000,1000,1000,1000,1000,1000},{3,4,91,95,185,265,266,347,351,434,516,520,602,604,605,690,691,778,860,861,864,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{3,94,184,265,350,433,519,604,690,777,860,863,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{8,9,94,101,191,269,270,350,357,440,519,526,604,609,610,695,696,784,863,864,869,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{8,16,17,100,101,110,190,200,276,277,350,357,365,439,448,526,535,610,617,618,703,704,783,793,869,870,877,1000,1000,1000,1000,1000,1000},{16,25,26,109,110,119,199,209,284,285,357,365,374,447,457,525,535,544,618,626,712,713,783,792,803,877,878,1000,1000,1000,1000,1000,1000},{25,35,119,128,208,218,293,365,374,456,465,534,544,554,626,635,721,792,802,812,886,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{44,128,227,301,374,474,554,635,730,802,822,895,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{44,54,138,147,227,237,310,384,393,474,483,554,564,574,644,653,739,812,822,832,904,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{54,63,64,147,148,157,227,237,247,318,319,394,403,483,493,564,575,584,654,662,748,749,823,832,842,913,914,1000,1000,1000,1000,1000,1000},{64,73,74,157,158,166,237,247,255,327,328,404,412,492,493,502,575,585,663,671,748,757,758,833,842,922,923,1000,1000,1000,1000,1000,1000},{74,82,166,167,247,255,335,336,413,501,502,509,585,593,672,757,765,766,843,931,932,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{82,174,255,342,421,509,593,679,765,771,851,939,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{83,88,174,175,256,261,342,343,422,509,510,514,594,599,680,766,771,772,852,939,940,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{84,88,89,175,176,179,257,262,342,343,344,423,427,510,511,515,595,600,681,685,767,772,773,853,857,940,941,1000,1000,1000,1000,1000,1000},{85,89,90,176,177,180,258,263,343,344,345,424,428,511,512,596,601,682,685,686,768,773,854,858,941,942,944,1000,1000,1000,1000,1000,1000},{86,90,177,178,259,344,345,425,429,512,513,597,683,686,687,769,855,859,942,943,945,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{81,173,254,341,420,508,592,684,764,850,938,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{72,81,165,245,334,420,500,583,678,756,841,850,930,938,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{72,156,236,326,420,491,573,670,747,841,930,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{34,118,198,292,383,455,553,634,711,801,894,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{24,108,118,198,283,373,446,543,625,702,711,791,801,885,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{15,108,198,275,364,438,533,616,702,791,876,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{2,93,183,264,349,432,518,603,689,776,862,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{1,2,92,182,264,348,431,517,602,603,688,689,775,861,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{1,91,181,264,347,430,516,602,688,774,860,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{8,100,190,269,356,439,525,609,695,783,863,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{16,100,109,199,276,356,447,525,534,609,617,703,792,869,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{25,109,208,284,356,456,534,617,712,802,877,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{63,147,246,318,393,492,574,653,748,822,913,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{63,73,157,246,327,403,492,501,574,584,662,757,832,922,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{73,166,246,335,412,501,584,671,765,842,931,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{88,179,261,346,427,514,599,685,771,857,944,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{89,179,180,262,346,428,514,515,600,686,772,858,944,945,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000},{90,180,263,346,429,515,601,687,773,859,945,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000,1000}};
+
+//number of TL2/TL3 cells checked (180, 429 or 945)
+const int L3_LIMIT=180;
+
+//minimal number of fired channels for TG5
+const int G_MASTER=5;
+
+//discriminator excitation time, in feed samples
+const int DET=40;
+
+//turn off broken channels (manually or via import of the trigger data)
+//channels 109-111 are not PMTs and never take part in the trigger
+const int triggermask[112]={1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0};
+
+#endif //TRIGGER_TABLES_H
@@ -8,6 +8,22 @@
 #include <thread>
 #include <functional>
 #include <random>
+#include <map>
+#include <tuple>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <iomanip>
+#include <filesystem>
+#include <memory>
+#include <chrono>
+#include <cerrno>
+#include <fcntl.h>
+#include <csignal>
+#include <unistd.h>
+
+#include "EventStore.h"
+#include "TriggerTables.h"
 
 std::vector<std::vector<int>> transpose(const std::vector<std::vector<int>>& matrix){
     if (matrix.empty() || matrix[0].empty()) {
@@ -44,6 +60,7 @@ private:
     const int INTERF_LENGTH = 6200;
     const int BIN_2_GEN = 1020;
     const float CURR_2_PH = 3. / 8;
+    const int STORE_SLOTS = 64; /// Число слотов в хранилище событий
     std::vector<std::vector<float>> pieds; /// Пьедесталы
     std::vector<float> curbase; /// Относительные токи
     std::vector<float> pulse; /// Импульсные характеристики тока
@@ -60,10 +77,23 @@ private:
     float MEAN_CURR{3.5}; /// Средний ток
     std::vector<std::vector<int>> data_out; /// Выводной массив
     std::vector<std::vector<float>> data; /// Данные
+    std::vector<int> active; /// Каналы, способные дать срабатывание
+    std::vector<float> noiseBound; /// Оценка сверху фона и наводки по каналам
+    unsigned seed; /// Сид генератора случайных чисел
+    std::mt19937 gen; /// Генератор случайных чисел
+    std::string shower; /// Имя файла ливня
+    uint64_t eventId{0}; /// Номер события при публикации в хранилище
+    float lazySigmas{5.f}; /// Запас на флуктуации фона в стандартных отклонениях
+
+    void AddPulse(int, int, float, int, int);
+
+    int Digitize(int, int, int, int, float);
+
+    bool CanTrigger() const;
 public:
     ModelElectronics();
 
-    void GetMoshits();
+    void GetMoshits(const std::string &);
 
     void GetSimple(const std::string &, std::vector<float> &);
 
@@ -77,11 +107,40 @@ public:
 
     void PrintDataOut();
 
+    void WriteDataOut(std::ostream &);
+
+    void PublishDataOut(const std::string &);
+
+    void PublishDataOut(EventStore &);
+
+    std::unique_ptr<EventStore> OpenStore(const std::string &) const;
+
+    bool EstimateSignal();
+
+    void PrepareLazy(float);
+
+    void ClearEvent();
+
+    bool SimulateEvent(bool);
+
+    void SetSeed(unsigned value) {
+        seed = value;
+        gen.seed(seed);
+    }
+
+    void SetEventId(uint64_t id) { eventId = id; }
+
+    float getLazySigmas() const { return lazySigmas; }
+
     std::vector<float> &getCurbaseRef() { return curbase; }
 
     std::vector<float> &getAmpRef() { return amp; }
 
     std::vector<float> &getPulseRef() { return pulse; }
+
+    std::vector<std::vector<int>> &getDataOutRef() { return data_out; }
+
+    std::vector<int> &getThrRef() { return thr; }
 };
 
 ModelElectronics::ModelElectronics() :
@@ -95,16 +154,27 @@ ModelElectronics::ModelElectronics() :
         interf_amp(N_CHAN, 0),
         thr(N_CHAN, 214),
         data_out(N_CHAN, std::vector<int>(BIN_2_GEN, 0)),
-        data(N_CHAN, std::vector<float>(BIN_2_GEN * 25 + 2 * PULSE_LENGTH + 2, 0)) {}
+        data(N_CHAN, std::vector<float>(BIN_2_GEN * 25 + 2 * PULSE_LENGTH + 2, 0)),
+        active(N_CHAN, 0),
+        noiseBound(N_CHAN, 0),
+        seed(std::random_device{}()),
+        gen(seed) {}
 
 /**
  * @brief Функция для считывания файла moshits
+ * @param fileName Имя файла ливня
  */
-void ModelElectronics::GetMoshits() {
-    std::ifstream moshits("mosaic_hits_m01_pro_10PeV_10-20_001_c001");
+void ModelElectronics::GetMoshits(const std::string &fileName) {
+    std::ifstream moshits(fileName);
+    shower = fileName;
+    PMTid.clear();
+    T.clear();
+    N_PHEL = 0;
+    Tmin = 0;
 
     if (!moshits.is_open()) {
-        std::cerr << "Failed to open the moshits file!" << std::endl;
+        std::cerr << "Failed to open the moshits file " << fileName << "!" << std::endl;
+        return;
     }
     N_PHEL = int(std::count(std::istreambuf_iterator<char>(moshits),
                             std::istreambuf_iterator<char>(), '\n')) - 1;
@@ -125,8 +195,9 @@ void ModelElectronics::GetMoshits() {
         PMTid.push_back(int(pmt_tmp));
         T.push_back(float(t_tmp));
     }
-    auto min_it{std::min_element(T.begin(), T.end())};
-    Tmin = *min_it;
+    if (!T.empty()) {
+        Tmin = *std::min_element(T.begin(), T.end());
+    }
     moshits.close();
 }
 
@@ -180,15 +251,11 @@ void ModelElectronics::GetC() {
 void ModelElectronics::GenerateEvent() {
     int T_ph;
     float amp_ph;
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dist(0, AMP_SIZE);
     for (int phid{0}; phid < N_PHEL; phid++) {
         amp_ph = amp[dist(gen)];
         T_ph = int(2 * (T[phid] - Tmin) + floor(0.45 * BIN_2_GEN * 25 + PULSE_LENGTH));
-        for (int t{0}; t < PULSE_LENGTH; t++) {
-            data[PMTid[phid]][t + T_ph] += amp_ph * pulse[t];
-        }
+        AddPulse(PMTid[phid], T_ph, amp_ph, 0, int(data[0].size()));
     }
 }
 
@@ -202,8 +269,6 @@ void ModelElectronics::AddBackground() {
     float amp_ph;
     int T_ph;
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dist_amp(0, AMP_SIZE);
     std::uniform_int_distribution<> dist_bg(0, BG_LENGTH);
 
@@ -211,13 +276,11 @@ void ModelElectronics::AddBackground() {
         N_AVG = MEAN_CURR * curbase[j] * CURR_2_PH;
         N_PHEL_exp = N_AVG * float(BG_LENGTH) / 25;
         std::poisson_distribution dist(N_PHEL_exp);
-        N_PHEL = dist(gen);
-        for (int n{0}; n < N_PHEL; n++) {
+        int N_BG{dist(gen)};
+        for (int n{0}; n < N_BG; n++) {
             amp_ph = amp[dist_amp(gen)];
             T_ph = dist_bg(gen);
-            for (int t{0}; t < PULSE_LENGTH; t++) {
-                data[j][t + T_ph] += amp_ph * pulse[t];
-            }
+            AddPulse(j, T_ph, amp_ph, 0, int(data[0].size()));
         }
     }
 
@@ -227,8 +290,6 @@ void ModelElectronics::AddBackground() {
  * @brief Имитация оцифровки
  */
 void ModelElectronics::SimulateDig() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dist_inter_length(0, INTERF_LENGTH);
     std::uniform_int_distribution<> dist_shift(0, 25);
     std::cout << "SimDig" << std::endl;
@@ -243,12 +304,139 @@ void ModelElectronics::SimulateDig() {
         }
         S_avg /= float(BIN_2_GEN) * 25;
         for (int i{0}; i < BIN_2_GEN; i++) {
-            data_out[j][i] = int((data[j][PULSE_LENGTH + t_shift + i * 25 + Toff[j]] - S_avg) /
-                                 Cal[j] + pieds[j][int(i % 2)] + pieds[j][int((i + 1) % 2)] +
-                                  interf_amp[j] * interf[(i * 25 + Toff[j] + t_f) % INTERF_LENGTH]);
+            data_out[j][i] = Digitize(j, i, t_shift, t_f, S_avg);
+        }
+    }
+
+}
+
+/**
+ * @brief Добавление одного импульса в канал с ограничением по времени
+ * @param chan Номер канала
+ * @param T_ph Время прихода фотоэлектрона
+ * @param amp_ph Амплитуда фотоэлектрона
+ * @param lo Начало моделируемого интервала
+ * @param hi Конец моделируемого интервала
+ */
+void ModelElectronics::AddPulse(int chan, int T_ph, float amp_ph, int lo, int hi) {
+    int t_begin{std::max(0, lo - T_ph)};
+    int t_end{std::min(PULSE_LENGTH, hi - T_ph)};
+    for (int t{t_begin}; t < t_end; t++) {
+        data[chan][t + T_ph] += amp_ph * pulse[t];
+    }
+}
+
+/**
+ * @brief Оцифровка одного отсчета канала
+ * @param j Номер канала
+ * @param i Номер бина
+ * @param t_shift Сдвиг оцифровки
+ * @param t_f Сдвиг наводки
+ * @param S_avg Средний уровень сигнала
+ * @return Код АЦП
+ */
+int ModelElectronics::Digitize(int j, int i, int t_shift, int t_f, float S_avg) {
+    return int((data[j][PULSE_LENGTH + t_shift + i * 25 + Toff[j]] - S_avg) /
+               Cal[j] + pieds[j][int(i % 2)] + pieds[j][int((i + 1) % 2)] +
+               interf_amp[j] * interf[(i * 25 + Toff[j] + t_f) % INTERF_LENGTH]);
+}
+
+/**
+ * @brief Подготовка оценки сверху вклада фона и наводки, коды АЦП
+ *
+ * Средний уровень фона вычитается при оцифровке вместе с S_avg, поэтому
+ * учитывается только флуктуация: sigmas стандартных отклонений суммы
+ * импульсов пуассоновского фона. Вызывается один раз после inputAll().
+ *
+ * @param sigmas Запас на флуктуации фона в стандартных отклонениях
+ */
+void ModelElectronics::PrepareLazy(float sigmas) {
+    lazySigmas = sigmas;
+    float amp2{std::inner_product(amp.begin(), amp.end(), amp.begin(), 0.f) / float(AMP_SIZE)};
+    float pulse2{std::inner_product(pulse.begin(), pulse.end(), pulse.begin(), 0.f)};
+    float interf_max{0};
+    for (auto v: interf) {
+        interf_max = std::max(interf_max, std::abs(v));
+    }
+    for (int j{0}; j < N_CHAN; j++) {
+        float rate{MEAN_CURR * curbase[j] * CURR_2_PH / 25};
+        noiseBound[j] = lazySigmas * std::sqrt(rate * amp2 * pulse2) / Cal[j] +
+                        std::abs(interf_amp[j]) * interf_max;
+    }
+}
+
+/**
+ * @brief Может ли набор активных каналов дать какой-либо триггер
+ *
+ * TG5 требует G_MASTER включенных каналов, TL2 и TL3 - двух и трех
+ * включенных каналов в одной ячейке triggers среди первых L3_LIMIT.
+ */
+bool ModelElectronics::CanTrigger() const {
+    int n_active{0};
+    std::vector<int> cells(L3_LIMIT, 0);
+    for (int j{0}; j < N_CHAN; j++) {
+        if (!active[j] || !triggermask[j]) {
+            continue;
+        }
+        n_active++;
+        for (int cell: triggers[j]) {
+            if (cell < L3_LIMIT && ++cells[cell] >= 2) {
+                return true;
+            }
         }
     }
+    return n_active >= G_MASTER;
+}
 
+/**
+ * @brief Отбор каналов по сгенерированному сигналу
+ *
+ * Вызывается после GenerateEvent(), пока в data только сигнал ливня.
+ * Максимум сигнала канала вместе с noiseBound сравнивается с порогом thr
+ * модели (не с levels.dat, по которому работает trigger_check). Каналы,
+ * не достигающие порога, помечаются неактивными.
+ *
+ * @return false, если событие не может дать ни TG5, ни TL2/TL3
+ */
+bool ModelElectronics::EstimateSignal() {
+    for (int j{0}; j < N_CHAN; j++) {
+        float peak{*std::max_element(data[j].begin(), data[j].end())};
+        active[j] = pieds[j][0] + pieds[j][1] + peak / Cal[j] + noiseBound[j] >= float(thr[j]);
+    }
+    return CanTrigger();
+}
+
+/**
+ * @brief Полное моделирование события
+ *
+ * При отборе фон и оцифровка моделируются только для принятых событий
+ * поверх уже разыгранного сигнала. Сигнал разыгрывается до фона и в
+ * обычном режиме, поэтому принятое событие совпадает с моделируемым без
+ * отбора при том же сиде.
+ *
+ * @param lazy Предварительный отбор событий, способных дать триггер
+ * @return false, если событие отброшено отбором
+ */
+bool ModelElectronics::SimulateEvent(bool lazy) {
+    GenerateEvent();
+    if (lazy && !EstimateSignal()) {
+        return false;
+    }
+    AddBackground();
+    SimulateDig();
+    return true;
+}
+
+/**
+ * @brief Очистка массивов события перед повторным моделированием
+ */
+void ModelElectronics::ClearEvent() {
+    for (auto &vec: data) {
+        std::fill(vec.begin(), vec.end(), 0.f);
+    }
+    for (auto &vec: data_out) {
+        std::fill(vec.begin(), vec.end(), 0);
+    }
 }
 
 /**
@@ -259,14 +447,61 @@ void ModelElectronics::PrintDataOut() {
     if (!outFile.is_open()) {
         std::cerr << "Open file error." << std::endl;
     }
+    WriteDataOut(outFile);
+    outFile.close();
+}
+
+/**
+ * @brief Запись выводного массива в поток (строка на бин)
+ * @param out Выходной поток
+ */
+void ModelElectronics::WriteDataOut(std::ostream &out) {
     std::vector<std::vector<int>> data_out_t = transpose(data_out);
     for (const auto &innerVec: data_out_t) {
         for (const auto &item: innerVec) {
-            outFile << item << ' ';
+            out << item << ' ';
         }
-        outFile << std::endl;
+        out << '\n';
     }
-    outFile.close();
+}
+
+/**
+ * @brief Публикация выводного массива в хранилище событий
+ * @param path Путь к файлу хранилища
+ */
+void ModelElectronics::PublishDataOut(const std::string &path) {
+    EventStore store(path, N_CHAN, BIN_2_GEN, STORE_SLOTS);
+    if (!store.is_open()) {
+        return;
+    }
+    PublishDataOut(store);
+}
+
+/**
+ * @brief Открытие хранилища событий с размерами кадра модели
+ * @param path Путь к файлу хранилища
+ * @return Хранилище или nullptr, если его не удалось открыть
+ */
+std::unique_ptr<EventStore> ModelElectronics::OpenStore(const std::string &path) const {
+    auto store{std::make_unique<EventStore>(path, N_CHAN, BIN_2_GEN, STORE_SLOTS)};
+    if (!store->is_open()) {
+        return nullptr;
+    }
+    return store;
+}
+
+/**
+ * @brief Публикация выводного массива в открытое хранилище событий
+ * @param store Хранилище событий
+ */
+void ModelElectronics::PublishDataOut(EventStore &store) {
+    EventStore::EventInfo info{};
+    info.eid = eventId;
+    info.seed = seed;
+    info.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    shower.copy(info.shower, sizeof(info.shower) - 1);
+    std::cout << "Event " << store.Publish(data_out, info) << " published" << std::endl;
 }
 
 /**
@@ -278,16 +513,17 @@ private:
 public:
     explicit ThreadManager(ModelElectronics &objRef) : obj(objRef) {}
 
-    void inputAll();
+    void inputAll(const std::string & = "mosaic_hits_m01_pro_10PeV_10-20_001_c001");
 };
 
 /**
  * @brief Метод для заполнения массивов в многопоточном режиме
+ * @param moshitsName Имя файла ливня
  */
-void ThreadManager::inputAll() {
+void ThreadManager::inputAll(const std::string &moshitsName) {
     std::vector<std::thread> threads;
     threads.emplace_back(&ModelElectronics::GetC, &obj);
-    threads.emplace_back(&ModelElectronics::GetMoshits, &obj);
+    threads.emplace_back(&ModelElectronics::GetMoshits, &obj, std::cref(moshitsName));
     threads.emplace_back(&ModelElectronics::GetSimple, &obj, "CurRels.dat", std::ref(obj.getCurbaseRef()));
     threads.emplace_back(&ModelElectronics::GetSimple, &obj, "Impulse2GHz.dat", std::ref(obj.getPulseRef()));
     threads.emplace_back(&ModelElectronics::GetSimple, &obj, "AmpDistrib.dat", std::ref(obj.getAmpRef()));
@@ -297,13 +533,947 @@ void ThreadManager::inputAll() {
 }
 
 
-int main() {
+/**
+ * @brief Результат эмуляции триггера для одного кадра
+ */
+struct TriggerResult {
+    char type{'E'}; /// Класс кадра: C, L, D или E, как в trigger_check
+    int TG5time{-1}; /// Время срабатывания TG5, -1 если не сработал
+    int TL2time{-1};
+    int TL3time{-1};
+
+    bool Triggered() const { return TG5time >= 0 || TL2time >= 0 || TL3time >= 0; }
+};
+
+/**
+ * @brief Класс для эмуляции триггера внутри моделирования
+ *
+ * Повторяет классификацию кадра и работу триггеров TG5/TL2/TL3 из
+ * trigger_check для кадра data_out без записи его в файл. Уровни
+ * дискриминаторов берутся как 4 * thr, поправка времени каналов не
+ * вводится, так как Toff в моделировании нулевые. Отключенные каналы
+ * triggermask исключаются так же, как в trigger_check.
+ */
+class TriggerEmulator {
+private:
+    const int LIVE_BINS = 512; /// Длина живого потока
+public:
+    TriggerResult Emulate(const std::vector<std::vector<int>> &, const std::vector<int> &) const;
+};
+
+/**
+ * @brief Эмуляция триггера
+ * @param frame Кадр [канал][бин]
+ * @param thr Пороги каналов
+ * @return Класс кадра и времена срабатывания триггеров
+ */
+TriggerResult TriggerEmulator::Emulate(const std::vector<std::vector<int>> &frame, const std::vector<int> &thr) const {
+    TriggerResult res;
+    auto n_chan{int(frame.size())};
+    auto n_bins{int(frame[0].size())};
+    std::vector<float> P1(n_chan, 0), P2(n_chan, 0);
+    auto value = [&](int i, int j) { return float(std::max(frame[i][j], 0)); };
+    auto ped = [&](int i, int j) { return j % 2 ? P1[i] : P2[i]; };
+    for (int i{0}; i < n_chan; i++) {
+        for (int j{10}; j < 410; j++) {
+            (j % 2 ? P1[i] : P2[i]) += value(i, j) / 200;
+        }
+    }
+
+    // классификация по полному потоку и длительности импульса
+    double signalSum{0};
+    std::vector<int> runs;
+    for (int i{0}; i < n_chan; i++) {
+        int run{0};
+        for (int j{0}; j < n_bins; j++) {
+            signalSum += value(i, j) - ped(i, j);
+            if (!triggermask[i] || j < 2 || j >= 900) {
+                continue;
+            }
+            if (value(i, j) > ped(i, j) + 5) {
+                run++;
+            } else {
+                if (run > 0) {
+                    runs.push_back(run);
+                }
+                run = 0;
+            }
+        }
+    }
+    std::vector<float> ultralevel(n_bins, 0);
+    if (signalSum > 3000000) {
+        res.type = 'C';
+    } else {
+        float ultralevelmax{0};
+        int pulsePosition{0};
+        for (int i{0}; i < n_chan; i++) {
+            float level{float(thr[i])};
+            float sum{0};
+            for (int j{0}; j < 900; j++) {
+                if (value(i, j) - ped(i, j) > level - P1[i]) {
+                    sum += value(i, j) - ped(i, j);
+                }
+            }
+            if (!triggermask[i] || sum > 3000) {
+                continue; // отключенный или неисправный канал
+            }
+            for (int j{10}; 2 * j + 1 < n_bins; j++) {
+                if (value(i, 2 * j) > level) {
+                    ultralevel[2 * j] += value(i, 2 * j) - P2[i];
+                }
+                if (value(i, 2 * j + 1) - P1[i] + P2[i] > level) {
+                    ultralevel[2 * j + 1] += value(i, 2 * j + 1) - P1[i];
+                }
+            }
+        }
+        for (int t{2 * 231}; t < 2 * 250; t++) {
+            if (ultralevel[t] > ultralevelmax) {
+                ultralevelmax = ultralevel[t];
+                pulsePosition = t;
+            }
+        }
+        while (pulsePosition > 0 && ultralevel[pulsePosition] > 0.1 * ultralevelmax) {
+            pulsePosition--;
+        }
+        pulsePosition++;
+        int pulseLength{0};
+        float pulseSum{0};
+        while (pulsePosition + 1 < n_bins && ultralevel[pulsePosition] > 0.1 * ultralevelmax) {
+            pulsePosition++;
+            pulseSum += ultralevel[pulsePosition];
+            pulseLength++;
+        }
+        int to3{0};
+        if (runs.size() > 3) {
+            std::nth_element(runs.begin(), runs.begin() + 3, runs.end(), std::greater<>());
+            to3 = runs[3];
+        }
+        if (pulseLength < 4 || 15 * std::pow(pulseLength, 2.5) / pulseSum < 1) {
+            res.type = 'L';
+        } else if (to3 > 50 || pulseLength > 160) {
+            res.type = 'D';
+        }
+    }
+
+    // живой поток: каждый второй бин, сумма четырех отсчетов против 4 * thr
+    std::vector<std::vector<int>> feed(n_chan, std::vector<int>(LIVE_BINS, 0));
+    for (int i{0}; i < n_chan; i++) {
+        for (int j{10}; j < LIVE_BINS; j++) {
+            feed[i][j] = 2 * j < n_bins - 1 ? int(value(i, 2 * j)) : int(P1[i]);
+        }
+    }
+    std::vector<int> timer(n_chan, 0);
+    std::vector<int> L3trigg(945, 0);
+    for (int j{0}; j < LIVE_BINS; j++) {
+        int k{0};
+        std::fill(L3trigg.begin(), L3trigg.end(), 0);
+        for (int i{0}; i < n_chan; i++) {
+            if (!triggermask[i]) {
+                continue;
+            }
+            int sum{0};
+            for (int d{0}; d < 4 && d <= j; d++) {
+                sum += feed[i][j - d];
+            }
+            if (sum > 4 * thr[i] && j > 0) {
+                timer[i] = DET;
+            } else if (--timer[i] <= 0) {
+                timer[i] = 0;
+                continue;
+            }
+            k++;
+            for (int cell: triggers[i]) {
+                if (cell < 900) {
+                    L3trigg[cell]++;
+                }
+            }
+        }
+        if (k >= G_MASTER && res.TG5time < 0) {
+            res.TG5time = j;
+        }
+        for (int c{0}; c < L3_LIMIT; c++) {
+            if (L3trigg[c] >= 3 && res.TL3time < 0) {
+                res.TL3time = j;
+            }
+            if (L3trigg[c] == 2 && res.TL2time < 0) {
+                res.TL2time = j;
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Гистограмма с равными бинами, допускающая слияние
+ */
+struct Histogram {
+    double lo{0};
+    double hi{0};
+    std::vector<uint64_t> counts;
+
+    Histogram(double lo_, double hi_, int n) : lo(lo_), hi(hi_), counts(n, 0) {}
+
+    void Fill(double x) {
+        if (x >= lo && x < hi) {
+            counts[size_t((x - lo) / (hi - lo) * double(counts.size()))]++;
+        }
+    }
+
+    void Merge(const Histogram &other) {
+        for (size_t b{0}; b < counts.size() && b < other.counts.size(); b++) {
+            counts[b] += other.counts[b];
+        }
+    }
+};
+
+/**
+ * @brief Класс для накопления статистики эффективности триггера
+ *
+ * Хранит счетчики классов кадров, гистограммы времен TG5/TL2/TL3 и долю
+ * сработавших событий по энергии и положению оси ливня. Накопители
+ * разных шардов и потоков объединяются методом Merge, текстовое
+ * представление читается обратно методом Read.
+ */
+class Aggregator {
+private:
+    struct Efficiency {
+        uint64_t events{0};
+        uint64_t triggered{0};
+    };
+
+    const int TIME_BINS = 128;
+    uint64_t events{0}; /// Всего событий
+    uint64_t rejected{0}; /// Отброшено предварительным отбором
+    std::map<char, uint64_t> classes{{'C', 0}, {'L', 0}, {'D', 0}, {'E', 0}}; /// Классы кадров
+    Histogram TG5{0, 512, TIME_BINS}; /// Времена срабатывания TG5
+    Histogram TL2{0, 512, TIME_BINS};
+    Histogram TL3{0, 512, TIME_BINS};
+    std::map<std::tuple<double, double, double>, Efficiency> efficiency; /// (энергия, x, y) -> счетчики
+public:
+    void Add(double, double, double, const TriggerResult &);
+
+    void AddRejected(double, double, double);
+
+    void Merge(const Aggregator &);
+
+    void Write(std::ostream &) const;
+
+    bool Read(std::istream &);
+};
+
+/**
+ * @brief Учет смоделированного события
+ * @param energy Энергия ливня
+ * @param x Координата оси ливня x
+ * @param y Координата оси ливня y
+ * @param res Результат эмуляции триггера
+ */
+void Aggregator::Add(double energy, double x, double y, const TriggerResult &res) {
+    events++;
+    classes[res.type]++;
+    if (res.TG5time >= 0) TG5.Fill(res.TG5time);
+    if (res.TL2time >= 0) TL2.Fill(res.TL2time);
+    if (res.TL3time >= 0) TL3.Fill(res.TL3time);
+    auto &eff{efficiency[{energy, x, y}]};
+    eff.events++;
+    eff.triggered += res.Triggered();
+}
+
+/**
+ * @brief Учет события, отброшенного предварительным отбором
+ */
+void Aggregator::AddRejected(double energy, double x, double y) {
+    events++;
+    rejected++;
+    efficiency[{energy, x, y}].events++;
+}
+
+void Aggregator::Merge(const Aggregator &other) {
+    events += other.events;
+    rejected += other.rejected;
+    for (const auto &[type, n]: other.classes) {
+        classes[type] += n;
+    }
+    TG5.Merge(other.TG5);
+    TL2.Merge(other.TL2);
+    TL3.Merge(other.TL3);
+    for (const auto &[key, eff]: other.efficiency) {
+        efficiency[key].events += eff.events;
+        efficiency[key].triggered += eff.triggered;
+    }
+}
+
+/**
+ * @brief Запись статистики в текстовом виде
+ * @param out Выходной поток
+ */
+void Aggregator::Write(std::ostream &out) const {
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "events " << events << '\n';
+    out << "rejected " << rejected << '\n';
+    out << "class";
+    for (const auto &[type, n]: classes) {
+        out << ' ' << type << ' ' << n;
+    }
+    out << '\n';
+    for (const auto &[name, hist]: {std::pair{"TG5", &TG5}, std::pair{"TL2", &TL2}, std::pair{"TL3", &TL3}}) {
+        out << "hist " << name << ' ' << hist->lo << ' ' << hist->hi << ' ' << hist->counts.size();
+        for (auto n: hist->counts) {
+            out << ' ' << n;
+        }
+        out << '\n';
+    }
+    for (const auto &[key, eff]: efficiency) {
+        out << "eff " << std::get<0>(key) << ' ' << std::get<1>(key) << ' ' << std::get<2>(key) << ' '
+            << eff.events << ' ' << eff.triggered << '\n';
+    }
+}
+
+/**
+ * @brief Чтение статистики, записанной методом Write
+ * @param in Входной поток
+ * @return false при ошибке формата
+ */
+bool Aggregator::Read(std::istream &in) {
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::string tag;
+        ss >> tag;
+        if (tag == "events") {
+            ss >> events;
+        } else if (tag == "rejected") {
+            ss >> rejected;
+        } else if (tag == "class") {
+            char type;
+            uint64_t n;
+            while (ss >> type >> n) {
+                classes[type] = n;
+            }
+            ss.clear();
+        } else if (tag == "hist") {
+            std::string name;
+            double lo, hi;
+            size_t n;
+            ss >> name >> lo >> hi >> n;
+            Histogram hist(lo, hi, int(n));
+            for (auto &c: hist.counts) {
+                ss >> c;
+            }
+            if (name == "TG5") {
+                TG5 = hist;
+            } else if (name == "TL2") {
+                TL2 = hist;
+            } else if (name == "TL3") {
+                TL3 = hist;
+            } else {
+                return false;
+            }
+        } else if (tag == "eff") {
+            double energy, x, y;
+            Efficiency eff;
+            ss >> energy >> x >> y >> eff.events >> eff.triggered;
+            efficiency[{energy, x, y}] = eff;
+        } else if (!tag.empty()) {
+            return false;
+        }
+        if (ss.fail()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Класс для запуска серий моделирования
+ *
+ * Манифест содержит строки "файл_ливня первый_сид последний_сид
+ * [энергия x y]".
+ * Диапазоны сидов делятся на шарды по SHARD_SIZE событий. Процессы, в том
+ * числе на разных узлах с общей файловой системой, захватывают шарды через
+ * файлы аренды в каталоге leases. Результат шарда пишется во временный файл
+ * и переименовывается в shards, так что наличие файла шарда означает его
+ * готовность, и при перезапуске посчитанные шарды пропускаются. Режим
+ * серии хранится в campaign.conf и должен совпадать при каждом запуске.
+ */
+class Campaign {
+private:
+    struct Shard {
+        std::string name;
+        std::string shower;
+        unsigned first;
+        unsigned last;
+        double energy; /// Энергия ливня (необязательный столбец манифеста)
+        double x; /// Положение оси ливня
+        double y;
+    };
+
+    const unsigned SHARD_SIZE = 16; /// Число событий в шарде
+    const std::chrono::seconds LEASE_TIMEOUT{600}; /// Время, после которого аренда считается брошенной
+    ModelElectronics &obj;
+    std::filesystem::path dir;
+    std::vector<Shard> shards;
+    std::string host; /// Имя узла
+    std::string owner; /// Имя процесса, к нему добавляется номер рабочего потока
+    bool lazy;
+    bool valid{true}; /// Манифест прочитан и каталог серии создан
+    bool aggregate{false}; /// Накопление статистики вместо записи кадров
+    unsigned sampleEvery{0}; /// В режиме накопления сохранять кадр каждого события с сидом, кратным sampleEvery
+    std::string storePath; /// Хранилище, куда дополнительно публикуются принятые события
+    TriggerEmulator emulator;
+
+    std::filesystem::path leasePath(const Shard &sh) const { return dir / "leases" / (sh.name + ".lease"); }
+
+    std::filesystem::path outPath(const Shard &sh) const { return dir / "shards" / (sh.name + ".out"); }
+
+    std::filesystem::path rawPath(const Shard &sh) const { return dir / "shards" / (sh.name + ".raw"); }
+
+    static std::string unitKey(const std::string &, double, double, double);
+
+    static std::string readLease(const std::filesystem::path &);
+
+    bool owns(const Shard &sh, const std::string &who) const { return readLease(leasePath(sh)) == who; }
+
+    bool deadOwner(const std::string &) const;
+
+    bool checkConfig() const;
+
+    void removeOrphans() const;
+
+    bool claim(const Shard &, const std::string &);
+
+    void release(const Shard &, const std::string &);
+
+    bool runShard(ModelElectronics &, std::string &, EventStore *, const Shard &, const std::string &);
+
+    static bool commit(std::ofstream &, const std::string &, const std::filesystem::path &);
+
+public:
+    Campaign(ModelElectronics &, const std::string &, const std::string &, bool);
+
+    bool ok() const { return valid; }
+
+    void SetAggregation(unsigned sample) {
+        aggregate = true;
+        sampleEvery = sample;
+    }
+
+    void SetStore(const std::string &path) { storePath = path; }
+
+    bool run(int);
+
+    bool merge();
+};
+
+/**
+ * @brief Чтение манифеста и разбиение на шарды
+ * @param objRef Модель электроники с загруженными входными данными
+ * @param manifest Имя файла манифеста
+ * @param dirName Рабочий каталог серии
+ * @param lazyMode Предварительный отбор событий
+ */
+Campaign::Campaign(ModelElectronics &objRef, const std::string &manifest, const std::string &dirName, bool lazyMode) :
+        obj(objRef), dir(dirName), lazy(lazyMode) {
+    std::ifstream input(manifest);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open the manifest " << manifest << "!" << std::endl;
+        valid = false;
+        return;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ss(line);
+        std::string shower;
+        unsigned first, last;
+        if (!(ss >> shower >> first >> last) || last < first) {
+            std::cerr << "Malformed manifest line: " << line << std::endl;
+            valid = false;
+            continue;
+        }
+        double energy{0}, x{0}, y{0};
+        ss >> energy >> x >> y;
+        std::string key{unitKey(shower, energy, x, y)};
+        for (unsigned seed{first}; seed <= last; seed += SHARD_SIZE) {
+            unsigned shardLast{std::min(last, seed + SHARD_SIZE - 1)};
+            shards.push_back({key + "_" + std::to_string(seed) + "_" + std::to_string(shardLast), shower, seed,
+                              shardLast, energy, x, y});
+            if (shardLast == last) {
+                break;
+            }
+        }
+    }
+    if (shards.empty()) {
+        std::cerr << "The manifest " << manifest << " has no work units!" << std::endl;
+        valid = false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(dir / "leases", ec);
+    if (!ec) {
+        std::filesystem::create_directories(dir / "shards", ec);
+    }
+    if (ec) {
+        std::cerr << "Failed to create the campaign directory " << dir << "!" << std::endl;
+        valid = false;
+    }
+    char name[256]{};
+    gethostname(name, sizeof(name) - 1);
+    host = name;
+    owner = host + "." + std::to_string(getpid());
+}
+
+/**
+ * @brief Имя рабочей единицы по ее содержимому
+ *
+ * Хеш FNV-1a от файла ливня, энергии и положения оси, так что вставка или
+ * перестановка строк манифеста не связывает готовые шарды с другой работой.
+ */
+std::string Campaign::unitKey(const std::string &shower, double energy, double x, double y) {
+    std::ostringstream ss;
+    ss.precision(std::numeric_limits<double>::max_digits10);
+    ss << shower << ' ' << energy << ' ' << x << ' ' << y;
+    uint64_t hash{14695981039346656037ull};
+    for (unsigned char c: ss.str()) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    std::ostringstream name;
+    name << 's' << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return name.str();
+}
+
+/**
+ * @brief Владелец аренды (первая строка файла), пусто при ошибке
+ */
+std::string Campaign::readLease(const std::filesystem::path &lease) {
+    std::ifstream in(lease);
+    std::string who;
+    std::getline(in, who);
+    return who;
+}
+
+/**
+ * @brief Захват шарда через файл аренды
+ *
+ * Аренда, не обновлявшаяся дольше LEASE_TIMEOUT, считается брошенной,
+ * как и аренда процесса этого узла, которого больше нет (deadOwner).
+ * Претендент переименовывает ее в свой файл и проверяет, что переименовал
+ * именно ту аренду, которую видел устаревшей (то же время изменения и тот
+ * же владелец). Если за это время аренду успел пересоздать другой
+ * процесс, она возвращается на место через link, который не затирает
+ * уже появившуюся аренду, и претендент отступает.
+ *
+ * @param who Имя рабочего потока
+ * @return true, если шард захвачен этим потоком
+ */
+bool Campaign::claim(const Shard &sh, const std::string &who) {
+    auto lease{leasePath(sh)};
+    int fd{open(lease.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644)};
+    if (fd < 0) {
+        if (errno != EEXIST) {
+            std::cerr << "Failed to create the lease " << lease << "!" << std::endl;
+            return false;
+        }
+        std::error_code ec;
+        std::string observed{readLease(lease)};
+        auto mtime{std::filesystem::last_write_time(lease, ec)};
+        if (ec || (std::filesystem::file_time_type::clock::now() - mtime < LEASE_TIMEOUT &&
+                   !deadOwner(observed))) {
+            return false;
+        }
+        auto stale{lease.string() + ".stale." + who};
+        std::filesystem::rename(lease, stale, ec);
+        if (ec) {
+            return false;
+        }
+        auto renamed{std::filesystem::last_write_time(stale, ec)};
+        if (ec || renamed != mtime || readLease(stale) != observed) {
+            if (link(stale.c_str(), lease.c_str()) != 0) {
+                std::cerr << "Lease " << lease << " was replaced during takeover" << std::endl;
+            }
+            std::filesystem::remove(stale, ec);
+            return false;
+        }
+        std::filesystem::remove(stale, ec);
+        fd = open(lease.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        std::cout << "Taking over stale shard " << sh.name << std::endl;
+    }
+    std::string text{who + "\n"};
+    if (write(fd, text.data(), text.size()) < 0) {
+        std::cerr << "Failed to write the lease " << lease << "!" << std::endl;
+    }
+    close(fd);
+    return true;
+}
+
+/**
+ * @brief Завершился ли процесс-владелец аренды или временного файла
+ *
+ * Проверить можно только процессы этого же узла: имя владельца
+ * host.pid[.thread], процесс считается завершенным, если kill(pid, 0)
+ * возвращает ESRCH.
+ *
+ * @param who Имя владельца
+ */
+bool Campaign::deadOwner(const std::string &who) const {
+    if (who.size() <= host.size() + 1 || who.compare(0, host.size() + 1, host + ".") != 0) {
+        return false;
+    }
+    char *end;
+    long pid{std::strtol(who.c_str() + host.size() + 1, &end, 10)};
+    if (pid <= 0 || pid == getpid() || (*end != '\0' && *end != '.')) {
+        return false;
+    }
+    return kill(pid_t(pid), 0) != 0 && errno == ESRCH;
+}
+
+/**
+ * @brief Проверка режима серии по файлу campaign.conf
+ *
+ * Режим (накопление, выборка кадров, предварительный отбор) записывается
+ * при первом запуске. Запуск в другом режиме смешал бы в каталоге
+ * несовместимые шарды, поэтому он отклоняется.
+ *
+ * @return true, если режим совпадает с записанным или записан впервые
+ */
+bool Campaign::checkConfig() const {
+    std::ostringstream conf;
+    conf.precision(std::numeric_limits<float>::max_digits10);
+    conf << "aggregate " << aggregate << "\nsample " << (aggregate ? sampleEvery : 0) << "\nlazy " << lazy
+         << "\nlazy-sigmas " << (lazy ? obj.getLazySigmas() : 0.f) << '\n';
+    auto path{dir / "campaign.conf"};
+    auto tmp{path.string() + ".tmp." + owner};
+    {
+        std::ofstream out(tmp);
+        out << conf.str();
+        if (!out) {
+            std::cerr << "Failed to write " << tmp << "!" << std::endl;
+            return false;
+        }
+    }
+    int res{link(tmp.c_str(), path.c_str())};
+    int err{errno};
+    std::error_code ec;
+    std::filesystem::remove(tmp, ec);
+    if (res != 0 && err != EEXIST) {
+        std::cerr << "Failed to write " << path << "!" << std::endl;
+        return false;
+    }
+    std::ifstream in(path);
+    std::stringstream saved;
+    saved << in.rdbuf();
+    if (saved.str() != conf.str()) {
+        std::cerr << "The campaign " << dir << " was started in another mode:\n" << saved.str() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Удаление временных файлов, брошенных завершившимися процессами
+ */
+void Campaign::removeOrphans() const {
+    std::error_code ec;
+    for (const auto &sub: {dir, dir / "shards", dir / "leases"}) {
+        for (const auto &entry: std::filesystem::directory_iterator(sub, ec)) {
+            auto name{entry.path().filename().string()};
+            for (const std::string mark: {".tmp.", ".stale."}) {
+                auto pos{name.find(mark)};
+                if (pos != std::string::npos && deadOwner(name.substr(pos + mark.size()))) {
+                    std::filesystem::remove(entry.path(), ec);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Снятие аренды, если она все еще принадлежит этому потоку
+ */
+void Campaign::release(const Shard &sh, const std::string &who) {
+    if (owns(sh, who)) {
+        std::error_code ec;
+        std::filesystem::remove(leasePath(sh), ec);
+    }
+}
+
+/**
+ * @brief Моделирование событий шарда с атомарной записью результата
+ *
+ * В режиме накопления файл шарда содержит статистику Aggregator, а кадры
+ * выбранных событий пишутся в отдельный файл .raw.
+ *
+ * Аренда продлевается после каждого события. Если она перешла к другому
+ * потоку, шард бросается без записи результата.
+ *
+ * @param model Модель электроники рабочего потока
+ * @param loaded Файл ливня, загруженный в модель
+ * @param store Хранилище для принятых событий или nullptr
+ * @param who Имя рабочего потока
+ * @return true, если файл шарда записан
+ */
+bool Campaign::runShard(ModelElectronics &model, std::string &loaded, EventStore *store, const Shard &sh,
+                        const std::string &who) {
+    if (loaded != sh.shower) {
+        model.GetMoshits(sh.shower);
+        loaded = sh.shower;
+    }
+    auto tmp{outPath(sh).string() + ".tmp." + who};
+    auto rawTmp{rawPath(sh).string() + ".tmp." + who};
+    std::ofstream out(tmp);
+    std::ofstream raw;
+    if (aggregate && sampleEvery > 0) {
+        raw.open(rawTmp);
+    }
+    if (!out.is_open() || (aggregate && sampleEvery > 0 && !raw.is_open())) {
+        std::cerr << "Failed to open " << tmp << "!" << std::endl;
+        return false;
+    }
+    Aggregator agg;
+    for (unsigned seed{sh.first}; seed <= sh.last; seed++) {
+        model.ClearEvent();
+        model.SetSeed(seed);
+        model.SetEventId(seed);
+        bool accepted{model.SimulateEvent(lazy)};
+        if (accepted && store) {
+            model.PublishDataOut(*store);
+        }
+        if (!aggregate) {
+            out << "# " << sh.shower << ' ' << seed << (accepted ? "\n" : " rejected\n");
+            if (accepted) {
+                model.WriteDataOut(out);
+            }
+        } else if (!accepted) {
+            agg.AddRejected(sh.energy, sh.x, sh.y);
+        } else {
+            TriggerResult res{emulator.Emulate(model.getDataOutRef(), model.getThrRef())};
+            agg.Add(sh.energy, sh.x, sh.y, res);
+            if (sampleEvery > 0 && seed % sampleEvery == 0) {
+                raw << "# " << sh.shower << ' ' << seed << ' ' << res.type << ' ' << res.TG5time << ' '
+                    << res.TL2time << ' ' << res.TL3time << '\n';
+                model.WriteDataOut(raw);
+            }
+        }
+        std::error_code ec;
+        if (!owns(sh, who)) {
+            std::cerr << "Lost the lease of shard " << sh.name << ", dropping it" << std::endl;
+            out.close();
+            raw.close();
+            std::filesystem::remove(tmp, ec);
+            std::filesystem::remove(rawTmp, ec);
+            return false;
+        }
+        std::filesystem::last_write_time(leasePath(sh), std::filesystem::file_time_type::clock::now(), ec);
+    }
+    if (aggregate) {
+        agg.Write(out);
+    }
+    if (raw.is_open() && !commit(raw, rawTmp, rawPath(sh))) {
+        return false;
+    }
+    return commit(out, tmp, outPath(sh));
+}
+
+/**
+ * @brief Закрытие временного файла и атомарное переименование
+ * @param out Поток временного файла
+ * @param tmp Имя временного файла
+ * @param path Итоговое имя
+ */
+bool Campaign::commit(std::ofstream &out, const std::string &tmp, const std::filesystem::path &path) {
+    out.close();
+    std::error_code ec;
+    if (!out) {
+        std::cerr << "Failed to write " << tmp << "!" << std::endl;
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::cerr << "Failed to commit " << path << ": " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Обработка всех доступных шардов и слияние результатов
+ *
+ * Каждый рабочий поток моделирует на своей копии модели, шарды между
+ * потоками делятся через те же файлы аренды, что и между процессами.
+ * С --store каждый поток открывает хранилище сам и публикует в него
+ * принятые события с номером, равным сиду.
+ *
+ * @param threads Число рабочих потоков
+ * @return Результат merge(), false также при несовпадении режима серии
+ */
+bool Campaign::run(int threads) {
+    if (!checkConfig()) {
+        return false;
+    }
+    removeOrphans();
+    auto worker = [this](const std::string &who) {
+        ModelElectronics model(obj);
+        std::string loaded;
+        std::unique_ptr<EventStore> store;
+        if (!storePath.empty()) {
+            store = model.OpenStore(storePath);
+            if (!store) {
+                return;
+            }
+        }
+        for (const auto &sh: shards) {
+            if (std::filesystem::exists(outPath(sh)) || !claim(sh, who)) {
+                continue;
+            }
+            if (!std::filesystem::exists(outPath(sh)) && runShard(model, loaded, store.get(), sh, who)) {
+                std::cout << "Shard " << sh.name << " done" << std::endl;
+            }
+            release(sh, who);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int n{0}; n < std::max(threads, 1); n++) {
+        workers.emplace_back(worker, owner + "." + std::to_string(n));
+    }
+    for (auto &t: workers) {
+        t.join();
+    }
+    return merge();
+}
+
+/**
+ * @brief Слияние результатов шардов в порядке манифеста
+ *
+ * Кадры шардов склеиваются, статистика режима накопления суммируется,
+ * выбранные кадры собираются в campaign.raw.
+ *
+ * @return true, если все шарды готовы и файл campaign.out записан
+ */
+bool Campaign::merge() {
+    int missing{0};
+    for (const auto &sh: shards) {
+        missing += !std::filesystem::exists(outPath(sh));
+    }
+    if (missing > 0) {
+        std::cout << missing << " of " << shards.size() << " shards are not finished yet" << std::endl;
+        return false;
+    }
+    Aggregator total;
+    if (aggregate) {
+        for (const auto &sh: shards) {
+            std::ifstream in(outPath(sh));
+            Aggregator part;
+            if (!part.Read(in)) {
+                std::cerr << "Malformed shard " << outPath(sh) << "!" << std::endl;
+                return false;
+            }
+            total.Merge(part);
+        }
+    }
+    auto tmp{(dir / "campaign.out").string() + ".tmp." + owner};
+    std::ofstream out(tmp, std::ios::binary);
+    if (aggregate) {
+        total.Write(out);
+        auto rawTmp{(dir / "campaign.raw").string() + ".tmp." + owner};
+        std::ofstream raw(rawTmp, std::ios::binary);
+        for (const auto &sh: shards) {
+            std::ifstream rawIn(rawPath(sh), std::ios::binary);
+            if (rawIn.is_open() && rawIn.peek() != std::ifstream::traits_type::eof()) {
+                raw << rawIn.rdbuf();
+            }
+        }
+        if (!commit(raw, rawTmp, dir / "campaign.raw")) {
+            return false;
+        }
+    } else {
+        for (const auto &sh: shards) {
+            std::ifstream in(outPath(sh), std::ios::binary);
+            out << in.rdbuf();
+        }
+    }
+    if (!commit(out, tmp, dir / "campaign.out")) {
+        return false;
+    }
+    std::cout << "Campaign merged into " << (dir / "campaign.out").string() << std::endl;
+    return true;
+}
+
+/**
+ * @brief Точка входа
+ *
+ * Без параметров моделируется одно событие и записывается в data_out.
+ * --lazy включает предварительный отбор: фон и оцифровка моделируются только
+ * для событий, сигнал которых с запасом --lazy-sigmas на фон может превысить
+ * пороги thr модели (по умолчанию 214) в числе каналов, достаточном для
+ * TG5/TL2/TL3. Пороги levels.dat, по которым работает trigger_check, при
+ * отборе не используются. Отброшенное событие не оставляет data_out, код
+ * возврата 2. --store PATH публикует события в хранилище вместо data_out,
+ * --campaign MANIFEST DIR запускает кампанию (с --store принятые события
+ * кампании также публикуются в хранилище).
+ */
+int main(int argc, char *argv[]) {
+    bool lazy{false};
+    float lazySigmas{5.f};
+    std::string storePath;
+    uint64_t eventId{0};
+    std::string manifest;
+    std::string campaignDir;
+    bool aggregate{false};
+    unsigned sampleEvery{0};
+    int threads{1};
+    for (int i{1}; i < argc; i++) {
+        if (std::string(argv[i]) == "--lazy") {
+            lazy = true;
+        } else if (std::string(argv[i]) == "--lazy-sigmas" && i + 1 < argc) {
+            lazySigmas = std::stof(argv[++i]);
+        } else if (std::string(argv[i]) == "--store" && i + 1 < argc) {
+            storePath = argv[++i];
+        } else if (std::string(argv[i]) == "--eid" && i + 1 < argc) {
+            eventId = std::stoull(argv[++i]);
+        } else if (std::string(argv[i]) == "--campaign" && i + 2 < argc) {
+            manifest = argv[++i];
+            campaignDir = argv[++i];
+        } else if (std::string(argv[i]) == "--aggregate") {
+            aggregate = true;
+        } else if (std::string(argv[i]) == "--sample" && i + 1 < argc) {
+            sampleEvery = unsigned(std::stoul(argv[++i]));
+        } else if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        }
+    }
     ModelElectronics model;
+    model.SetEventId(eventId);
     ThreadManager manager(model);
     manager.inputAll();
-    model.GenerateEvent();
-    model.AddBackground();
-    model.SimulateDig();
-    model.PrintDataOut();
+    model.PrepareLazy(lazySigmas);
+    if (!manifest.empty()) {
+        Campaign campaign(model, manifest, campaignDir, lazy);
+        if (!campaign.ok()) {
+            return 1;
+        }
+        if (aggregate) {
+            campaign.SetAggregation(sampleEvery);
+        }
+        campaign.SetStore(storePath);
+        return campaign.run(threads) ? 0 : 1;
+    }
+    if (!model.SimulateEvent(lazy)) {
+        std::cout << "Event rejected" << std::endl;
+        if (storePath.empty()) {
+            std::error_code ec;
+            std::filesystem::remove("data_out", ec);
+        }
+        return 2;
+    }
+    if (storePath.empty()) {
+        model.PrintDataOut();
+    } else {
+        model.PublishDataOut(storePath);
+    }
     return 0;
 }